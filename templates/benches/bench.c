@@ -0,0 +1,601 @@
+/**
+ * Carbide benchmark harness implementation.
+ */
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#endif
+
+#include "bench.h"
+#include "bench_counters.h"
+#include "bench_memory.h"
+#include "histogram.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* ============================================================
+ * Types
+ * ============================================================ */
+
+#define BENCH_MAX_REPETITIONS 100
+#define BENCH_MAX_ITERATIONS ((uint64_t)1 << 40)
+
+struct BenchContext {
+    uint64_t iterations;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    bool has_begun;
+    bool has_ended;
+    BenchCounters *counters;  /* Borrowed, NULL = unavailable */
+    BenchCounterValues counter_values;
+    BenchMemorySnapshot memory_start;
+    BenchMemorySnapshot memory_end;
+    Histogram *latency;       /* Borrowed, NULL = not recording */
+    const char *failure;      /* From bench_fail(), NULL = none */
+};
+
+/* Measurements from one call of a benchmark body */
+typedef struct {
+    uint64_t elapsed_ns;
+    BenchCounterValues counters;
+    BenchMemorySnapshot memory_start;
+    BenchMemorySnapshot memory_end;
+    const char *failure;
+} RunSample;
+
+typedef struct {
+    const char *name;
+    uint64_t iterations;
+    uint32_t repetitions;
+    double ns_per_op_min;
+    double ns_per_op_median;
+    double ns_per_op_max;
+    double counter_per_op[BENCH_COUNTER_COUNT];
+    bool has_counter[BENCH_COUNTER_COUNT];
+    double allocs_per_op;
+    double alloc_bytes_per_op;
+    double page_faults_per_op;
+    uint64_t peak_rss_kb;      /* 0 = unknown */
+    bool has_alloc;
+    bool has_page_faults;
+    bool is_alloc_free;
+    bool has_failed;           /* Allocation-free benchmark allocated */
+    const char *failure;       /* From bench_fail(), NULL = none */
+    uint64_t latency_count;    /* Operations recorded, 0 = none */
+    uint64_t latency_p50_ns;
+    uint64_t latency_p99_ns;
+    uint64_t latency_p999_ns;
+    uint64_t latency_max_ns;
+} BenchResult;
+
+/* ============================================================
+ * Private Functions
+ * ============================================================ */
+
+static uint64_t now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static bool is_valid_name(const char *name) {
+    if (!name || name[0] == '\0') return false;
+
+    for (const char *c = name; *c; c++) {
+        bool is_allowed = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') ||
+                          (*c >= '0' && *c <= '9') || *c == '_' || *c == '-' ||
+                          *c == '.' || *c == '/';
+        if (!is_allowed) return false;
+    }
+    return true;
+}
+
+static bool is_selected(const BenchCase *bench, const BenchConfig *config) {
+    if (config->only) {
+        return strcmp(bench->name, config->only) == 0;
+    }
+    if (config->filter) {
+        return strstr(bench->name, config->filter) != NULL;
+    }
+    return true;
+}
+
+/* Run the body once with a fixed iteration count */
+static void run_once(const BenchCase *bench, uint64_t iterations, BenchCounters *counters,
+                     Histogram *latency, RunSample *out) {
+    BenchContext ctx = {0};
+    ctx.iterations = iterations;
+    ctx.counters = counters;
+    ctx.latency = latency;
+
+    // bench_begin() restarts the clock, counters and memory snapshot
+    bench_memory_snapshot(&ctx.memory_start);
+    bench_counters_start(counters);
+    uint64_t call_start = now_ns();
+    bench->func(&ctx, bench->user_data);
+    uint64_t call_end = now_ns();
+    if (!ctx.has_ended) {
+        bench_counters_stop(counters, &ctx.counter_values);
+        bench_memory_snapshot(&ctx.memory_end);
+    }
+
+    uint64_t start = ctx.has_begun ? ctx.start_ns : call_start;
+    uint64_t end = ctx.has_ended ? ctx.end_ns : call_end;
+    out->elapsed_ns = end > start ? end - start : 0;
+    out->counters = ctx.counter_values;
+    out->memory_start = ctx.memory_start;
+    out->memory_end = ctx.memory_end;
+    out->failure = ctx.failure;
+}
+
+/* Grow the iteration count until one run takes at least min_time_ms; 0 if the body failed */
+static uint64_t calibrate(const BenchCase *bench, uint32_t min_time_ms,
+                          const char **out_failure) {
+    const uint64_t target_ns = (uint64_t)min_time_ms * 1000000u;
+    uint64_t iterations = 1;
+
+    for (;;) {
+        RunSample sample;
+        run_once(bench, iterations, NULL, NULL, &sample);
+        if (sample.failure) {
+            *out_failure = sample.failure;
+            return 0;
+        }
+        uint64_t elapsed = sample.elapsed_ns;
+        if (elapsed >= target_ns || iterations >= BENCH_MAX_ITERATIONS) {
+            return iterations;
+        }
+
+        // Aim 20% past the target, but grow at most 10x per step
+        uint64_t next = iterations * 10;
+        if (elapsed > 0) {
+            double scale = (double)target_ns * 1.2 / (double)elapsed;
+            if (scale < 10.0) {
+                next = (uint64_t)((double)iterations * scale) + 1;
+            }
+        }
+        iterations = next < BENCH_MAX_ITERATIONS ? next : BENCH_MAX_ITERATIONS;
+    }
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_bench(const BenchCase *bench, const BenchConfig *config,
+                      BenchCounters *counters, Histogram *latency, BenchResult *out) {
+    double samples[BENCH_MAX_REPETITIONS];
+    *out = (BenchResult){.name = bench->name};
+    uint32_t repetitions = config->repetitions;
+    if (repetitions == 0) repetitions = 1;
+    if (repetitions > BENCH_MAX_REPETITIONS) repetitions = BENCH_MAX_REPETITIONS;
+
+    // Peak RSS covers calibration and every repetition of this benchmark
+    bench_memory_reset_peak_rss();
+
+    // Calibration doubles as warm-up; fixed counts skip it so that
+    // instruction counts stay proportional to the iteration count
+    uint64_t iterations = config->iterations;
+    if (iterations == 0) {
+        iterations = calibrate(bench, config->min_time_ms, &out->failure);
+        if (out->failure) return;
+    }
+
+    // Counters are summed over every repetition; an event missing from any
+    // repetition (e.g. never scheduled) is reported as unavailable
+    uint64_t counter_totals[BENCH_COUNTER_COUNT] = {0};
+    bool has_counter[BENCH_COUNTER_COUNT];
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        has_counter[c] = counters != NULL;
+    }
+
+    uint64_t alloc_count = 0;
+    uint64_t alloc_bytes = 0;
+    uint64_t page_faults = 0;
+    bool has_alloc = true;
+    bool has_page_faults = true;
+
+    histogram_reset(latency);
+    for (uint32_t i = 0; i < repetitions; i++) {
+        RunSample sample;
+        run_once(bench, iterations, counters, latency, &sample);
+        if (sample.failure) {
+            out->failure = sample.failure;
+            return;
+        }
+        samples[i] = (double)sample.elapsed_ns / (double)iterations;
+
+        for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+            has_counter[c] = has_counter[c] && sample.counters.has_value[c];
+            counter_totals[c] += sample.counters.values[c];
+        }
+
+        const BenchMemorySnapshot *m0 = &sample.memory_start;
+        const BenchMemorySnapshot *m1 = &sample.memory_end;
+        has_alloc = has_alloc && m0->has_alloc && m1->has_alloc;
+        has_page_faults = has_page_faults && m0->has_page_faults && m1->has_page_faults;
+        alloc_count += m1->alloc_count - m0->alloc_count;
+        alloc_bytes += m1->alloc_bytes - m0->alloc_bytes;
+        page_faults += m1->page_faults - m0->page_faults;
+    }
+    qsort(samples, repetitions, sizeof(samples[0]), compare_double);
+
+    double total_ops = (double)iterations * (double)repetitions;
+    for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+        out->has_counter[c] = has_counter[c];
+        out->counter_per_op[c] = has_counter[c] ? (double)counter_totals[c] / total_ops : 0.0;
+    }
+
+    out->has_alloc = has_alloc;
+    out->has_page_faults = has_page_faults;
+    out->allocs_per_op = has_alloc ? (double)alloc_count / total_ops : 0.0;
+    out->alloc_bytes_per_op = has_alloc ? (double)alloc_bytes / total_ops : 0.0;
+    out->page_faults_per_op = has_page_faults ? (double)page_faults / total_ops : 0.0;
+    out->peak_rss_kb = bench_memory_get_peak_rss_kb();
+    out->is_alloc_free = bench->is_alloc_free;
+    out->has_failed = bench->is_alloc_free && has_alloc && alloc_count > 0;
+
+    out->latency_count = histogram_get_total_count(latency);
+    out->latency_p50_ns = histogram_get_value_at_percentile(latency, 50.0);
+    out->latency_p99_ns = histogram_get_value_at_percentile(latency, 99.0);
+    out->latency_p999_ns = histogram_get_value_at_percentile(latency, 99.9);
+    out->latency_max_ns = histogram_get_max(latency);
+
+    out->iterations = iterations;
+    out->repetitions = repetitions;
+    out->ns_per_op_min = samples[0];
+    out->ns_per_op_median = samples[repetitions / 2];
+    out->ns_per_op_max = samples[repetitions - 1];
+}
+
+static double result_get_ipc(const BenchResult *r) {
+    if (!r->has_counter[BENCH_COUNTER_CYCLES] || !r->has_counter[BENCH_COUNTER_INSTRUCTIONS] ||
+        r->counter_per_op[BENCH_COUNTER_CYCLES] <= 0.0) {
+        return -1.0;
+    }
+    return r->counter_per_op[BENCH_COUNTER_INSTRUCTIONS] / r->counter_per_op[BENCH_COUNTER_CYCLES];
+}
+
+/* Print a counter column, or "-" when the counter is unavailable */
+static void print_counter(double value, bool has_value, int width, int precision) {
+    if (has_value) {
+        printf(" %*.*f", width, precision, value);
+    } else {
+        printf(" %*s", width, "-");
+    }
+}
+
+static void print_result(const BenchResult *r) {
+    double ipc = result_get_ipc(r);
+
+    printf("%-32s %12llu %12.2f %12.2f", r->name, (unsigned long long)r->iterations,
+           r->ns_per_op_min, r->ns_per_op_median);
+    print_counter(ipc, ipc >= 0.0, 6, 2);
+    print_counter(r->counter_per_op[BENCH_COUNTER_INSTRUCTIONS],
+                  r->has_counter[BENCH_COUNTER_INSTRUCTIONS], 12, 1);
+    print_counter(r->counter_per_op[BENCH_COUNTER_CACHE_MISSES],
+                  r->has_counter[BENCH_COUNTER_CACHE_MISSES], 14, 3);
+    print_counter(r->counter_per_op[BENCH_COUNTER_BRANCH_MISSES],
+                  r->has_counter[BENCH_COUNTER_BRANCH_MISSES], 12, 3);
+    printf("\n");
+}
+
+static void print_memory_results(const BenchResult *results, size_t count) {
+    printf("\n%-32s %12s %12s %12s %14s\n", "Memory", "allocs/op", "bytes/op", "faults/op",
+           "peak RSS (KiB)");
+    for (size_t i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        printf("%-32s", r->name);
+        print_counter(r->allocs_per_op, r->has_alloc, 12, 3);
+        print_counter(r->alloc_bytes_per_op, r->has_alloc, 12, 1);
+        print_counter(r->page_faults_per_op, r->has_page_faults, 12, 4);
+        print_counter((double)r->peak_rss_kb, r->peak_rss_kb > 0, 14, 0);
+        printf("%s\n", r->has_failed ? "  FAIL (allocation-free)" : "");
+    }
+}
+
+static void print_latency_results(const BenchResult *results, size_t count) {
+    bool has_any = false;
+    for (size_t i = 0; i < count; i++) {
+        has_any = has_any || results[i].latency_count > 0;
+    }
+    if (!has_any) return;
+
+    printf("\n%-32s %12s %12s %12s %12s %12s\n", "Latency (ns)", "ops", "p50", "p99", "p99.9",
+           "max");
+    for (size_t i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        if (r->latency_count == 0) continue;
+        printf("%-32s %12llu %12llu %12llu %12llu %12llu\n", r->name,
+               (unsigned long long)r->latency_count, (unsigned long long)r->latency_p50_ns,
+               (unsigned long long)r->latency_p99_ns, (unsigned long long)r->latency_p999_ns,
+               (unsigned long long)r->latency_max_ns);
+    }
+}
+
+/* Write a JSON integer, or null when the value is unavailable */
+static void write_json_integer(FILE *f, const char *key, uint64_t value, bool has_value) {
+    if (has_value) {
+        fprintf(f, ", \"%s\": %llu", key, (unsigned long long)value);
+    } else {
+        fprintf(f, ", \"%s\": null", key);
+    }
+}
+
+/* Write a JSON number, or null when the value is unavailable */
+static void write_json_number(FILE *f, const char *key, double value, bool has_value) {
+    if (has_value) {
+        fprintf(f, ", \"%s\": %.3f", key, value);
+    } else {
+        fprintf(f, ", \"%s\": null", key);
+    }
+}
+
+static bool write_json(const char *path, const BenchResult *results, size_t count) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "bench: failed to open JSON output (path=%s, error=%s)\n",
+                path, strerror(errno));
+        return false;
+    }
+
+    // One benchmark object per line keeps the output diffable and easy to
+    // consume from line-oriented scripts
+    fprintf(f, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        double ipc = result_get_ipc(r);
+
+        fprintf(f,
+                "    {\"name\": \"%s\", \"iterations\": %llu, \"repetitions\": %u, "
+                "\"ns_per_op_min\": %.3f, \"ns_per_op_median\": %.3f, "
+                "\"ns_per_op_max\": %.3f",
+                r->name, (unsigned long long)r->iterations, r->repetitions,
+                r->ns_per_op_min, r->ns_per_op_median, r->ns_per_op_max);
+        for (int c = 0; c < BENCH_COUNTER_COUNT; c++) {
+            char key[64];
+            snprintf(key, sizeof(key), "%s_per_op", bench_counter_get_name((BenchCounter)c));
+            write_json_number(f, key, r->counter_per_op[c], r->has_counter[c]);
+        }
+        write_json_number(f, "ipc", ipc, ipc >= 0.0);
+        write_json_number(f, "allocs_per_op", r->allocs_per_op, r->has_alloc);
+        write_json_number(f, "alloc_bytes_per_op", r->alloc_bytes_per_op, r->has_alloc);
+        write_json_number(f, "page_faults_per_op", r->page_faults_per_op, r->has_page_faults);
+        write_json_integer(f, "peak_rss_kb", r->peak_rss_kb, r->peak_rss_kb > 0);
+        bool has_latency = r->latency_count > 0;
+        write_json_integer(f, "latency_p50_ns", r->latency_p50_ns, has_latency);
+        write_json_integer(f, "latency_p99_ns", r->latency_p99_ns, has_latency);
+        write_json_integer(f, "latency_p999_ns", r->latency_p999_ns, has_latency);
+        write_json_integer(f, "latency_max_ns", r->latency_max_ns, has_latency);
+        fprintf(f, ", \"alloc_free\": %s", r->is_alloc_free ? "true" : "false");
+        fprintf(f, "}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+
+    if (fclose(f) != 0) {
+        fprintf(stderr, "bench: failed to write JSON output (path=%s)\n", path);
+        return false;
+    }
+    return true;
+}
+
+static bool parse_u64(const char *text, uint64_t *out) {
+    if (!text || text[0] < '0' || text[0] > '9') return false;
+
+    char *end = NULL;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (errno != 0 || *end != '\0') return false;
+
+    *out = (uint64_t)value;
+    return true;
+}
+
+static void print_usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --list             List benchmark names and exit\n"
+            "  --filter SUBSTR    Run benchmarks whose name contains SUBSTR\n"
+            "  --only NAME        Run only the benchmark named NAME\n"
+            "  --iterations N     Fixed iteration count (no calibration)\n"
+            "  --min-time MS      Calibration target per repetition (default 100)\n"
+            "  --repetitions N    Timed runs per benchmark (default 5)\n"
+            "  --json PATH        Also write results as JSON to PATH\n",
+            program);
+}
+
+/* ============================================================
+ * Public Functions
+ * ============================================================ */
+
+uint64_t bench_get_iterations(const BenchContext *ctx) {
+    return ctx ? ctx->iterations : 0;
+}
+
+void bench_begin(BenchContext *ctx) {
+    if (!ctx) return;
+    ctx->has_begun = true;
+    ctx->has_ended = false;
+    bench_memory_snapshot(&ctx->memory_start);
+    bench_counters_start(ctx->counters);
+    ctx->start_ns = now_ns();
+}
+
+void bench_end(BenchContext *ctx) {
+    if (!ctx || !ctx->has_begun) return;
+    ctx->end_ns = now_ns();
+    bench_counters_stop(ctx->counters, &ctx->counter_values);
+    bench_memory_snapshot(&ctx->memory_end);
+    ctx->has_ended = true;
+}
+
+uint64_t bench_now_ns(void) {
+    return now_ns();
+}
+
+void bench_record_latency(BenchContext *ctx, uint64_t latency_ns) {
+    if (!ctx || !ctx->latency) return;
+    histogram_record(ctx->latency, latency_ns);
+}
+
+void bench_fail(BenchContext *ctx, const char *reason) {
+    if (!ctx || ctx->failure) return;  // Keep the first reason
+    ctx->failure = reason ? reason : "failed";
+}
+
+bool bench_run(const BenchCase *cases, size_t count, const BenchConfig *config) {
+    BenchConfig default_config = BENCH_CONFIG_DEFAULT;
+    if (!config) {
+        config = &default_config;
+    }
+    if (!cases && count > 0) {
+        fprintf(stderr, "bench: cases is NULL\n");
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!is_valid_name(cases[i].name) || !cases[i].func) {
+            fprintf(stderr, "bench: invalid benchmark at index %zu (name=%s)\n",
+                    i, cases[i].name ? cases[i].name : "(null)");
+            return false;
+        }
+    }
+
+    BenchResult *results = calloc(count > 0 ? count : 1, sizeof(BenchResult));
+    if (!results) {
+        fprintf(stderr, "bench: failed to allocate results (count=%zu)\n", count);
+        return false;
+    }
+
+    // Counters are optional: without permission the harness reports time only
+    BenchCounters *counters = bench_counters_create();
+    if (!counters) {
+        fprintf(stderr,
+                "bench: hardware counters unavailable (error=%s), reporting time only\n",
+                strerror(errno));
+    }
+    // One histogram reused for every benchmark: allocated once, reset per run
+    Histogram *latency = histogram_create(NULL);
+    if (!latency) {
+        fprintf(stderr, "bench: failed to allocate latency histogram\n");
+        bench_counters_destroy(counters);
+        free(results);
+        return false;
+    }
+    if (!bench_memory_has_alloc_hooks()) {
+        fprintf(stderr, "bench: allocator hooks not linked, allocation counts unavailable\n");
+    }
+
+    printf("%-32s %12s %12s %12s %6s %12s %14s %12s\n", "Benchmark", "Iterations",
+           "ns/op (min)", "ns/op (med)", "IPC", "instr/op", "cache-miss/op", "br-miss/op");
+
+    // A failed benchmark has no numbers: it is reported here and left out
+    // of the memory, latency and JSON results
+    size_t result_count = 0;
+    size_t failed_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!is_selected(&cases[i], config)) continue;
+
+        BenchResult *r = &results[result_count];
+        run_bench(&cases[i], config, counters, latency, r);
+        if (r->failure) {
+            printf("%-32s FAIL (%s)\n", r->name, r->failure);
+            fprintf(stderr, "bench: benchmark failed (name=%s, reason=%s)\n", r->name,
+                    r->failure);
+            failed_count++;
+        } else {
+            print_result(r);
+            result_count++;
+        }
+        fflush(stdout);
+    }
+    bench_counters_destroy(counters);
+    histogram_destroy(latency);
+
+    if (result_count > 0) {
+        print_memory_results(results, result_count);
+        print_latency_results(results, result_count);
+        fflush(stdout);
+    }
+
+    bool is_ok = failed_count == 0;
+    for (size_t i = 0; i < result_count; i++) {
+        if (results[i].has_failed) {
+            fprintf(stderr,
+                    "bench: allocation-free benchmark allocated (name=%s, allocs_per_op=%.3f)\n",
+                    results[i].name, results[i].allocs_per_op);
+            is_ok = false;
+        }
+    }
+
+    if (result_count == 0 && failed_count == 0) {
+        fprintf(stderr, "bench: no benchmarks matched\n");
+        is_ok = false;
+    } else if (result_count > 0 && config->json_path &&
+               !write_json(config->json_path, results, result_count)) {
+        is_ok = false;
+    }
+
+    free(results);
+    return is_ok;
+}
+
+int bench_main(int argc, char **argv, const BenchCase *cases, size_t count) {
+    BenchConfig config = BENCH_CONFIG_DEFAULT;
+    const char *program = argc > 0 ? argv[0] : "bench";
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        uint64_t number = 0;
+
+        if (strcmp(arg, "--list") == 0) {
+            for (size_t j = 0; j < count; j++) {
+                printf("%s\n", cases[j].name);
+            }
+            return EXIT_SUCCESS;
+        } else if (strcmp(arg, "--filter") == 0 && value) {
+            config.filter = value;
+        } else if (strcmp(arg, "--only") == 0 && value) {
+            config.only = value;
+        } else if (strcmp(arg, "--json") == 0 && value) {
+            config.json_path = value;
+        } else if (strcmp(arg, "--iterations") == 0 && parse_u64(value, &number) &&
+                   number > 0 && number <= BENCH_MAX_ITERATIONS) {
+            config.iterations = number;
+        } else if (strcmp(arg, "--min-time") == 0 && parse_u64(value, &number) &&
+                   number <= 60000) {
+            config.min_time_ms = (uint32_t)number;
+        } else if (strcmp(arg, "--repetitions") == 0 && parse_u64(value, &number) &&
+                   number > 0 && number <= BENCH_MAX_REPETITIONS) {
+            config.repetitions = (uint32_t)number;
+        } else {
+            fprintf(stderr, "bench: invalid option (arg=%s)\n", arg);
+            print_usage(program);
+            return EXIT_FAILURE;
+        }
+        i++;  // Every remaining option takes a value
+    }
+
+    return bench_run(cases, count, &config) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
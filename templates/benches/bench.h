@@ -0,0 +1,140 @@
+/**
+ * Carbide benchmark harness.
+ *
+ * Benchmarks are plain functions listed in a BenchCase table and run by
+ * bench_main(). Each benchmark times only the region between
+ * bench_begin() and bench_end() (or the whole call if neither is used).
+ * Per-operation latencies recorded with bench_record_latency() are
+ * collected in an HDR histogram (histogram.h) and reported as percentiles.
+ *
+ * Thread-safe: No (run benchmarks from a single thread)
+ */
+#ifndef CARBIDE_BENCH_H
+#define CARBIDE_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ * Types
+ * ============================================================ */
+
+typedef struct BenchContext BenchContext;
+
+/**
+ * Benchmark body. Must run the measured operation exactly
+ * bench_get_iterations(ctx) times.
+ */
+typedef void (*BenchFunc)(BenchContext *ctx, void *user_data);
+
+typedef struct {
+    const char *name;     /* Letters, digits, '_', '-', '.', '/' only */
+    BenchFunc func;
+    void *user_data;
+    bool is_alloc_free;   /* Fail the run if the timed region allocates */
+} BenchCase;
+
+typedef struct {
+    uint64_t iterations;    /* Fixed iteration count, 0 = calibrate */
+    uint32_t min_time_ms;   /* Calibration target per repetition */
+    uint32_t repetitions;   /* Timed runs per benchmark */
+    const char *filter;     /* Run names containing this, NULL = all */
+    const char *only;       /* Run only this exact name, NULL = all */
+    const char *json_path;  /* Write results as JSON, NULL = don't */
+} BenchConfig;
+
+#define BENCH_CONFIG_DEFAULT { \
+    .iterations = 0, \
+    .min_time_ms = 100, \
+    .repetitions = 5, \
+    .filter = NULL, \
+    .only = NULL, \
+    .json_path = NULL \
+}
+
+/* ============================================================
+ * Measurement
+ * ============================================================ */
+
+/** Number of times the benchmark body must run the operation. */
+uint64_t bench_get_iterations(const BenchContext *ctx);
+
+/** Start the timed region (excludes setup done before this call). */
+void bench_begin(BenchContext *ctx);
+
+/** End the timed region (excludes cleanup done after this call). */
+void bench_end(BenchContext *ctx);
+
+/** Monotonic clock in nanoseconds, for timing individual operations. */
+uint64_t bench_now_ns(void);
+
+/**
+ * Record the latency of one operation into the benchmark's histogram.
+ *
+ * Benchmarks that call this get p50/p99/p99.9 latency in their results.
+ * Ignored during calibration. Timing every operation adds clock overhead
+ * (~20 ns), so use it for operations well above that.
+ *
+ * @param latency_ns Duration of one operation, e.g. from bench_now_ns()
+ */
+void bench_record_latency(BenchContext *ctx, uint64_t latency_ns);
+
+/**
+ * Fail the benchmark, e.g. when setup fails or a server stalls. The body
+ * should return right after. The benchmark is reported as FAIL instead of
+ * a time, its remaining repetitions are skipped, and bench_run() returns
+ * false.
+ *
+ * @param reason Shown in the report; must outlive bench_run() (a literal)
+ */
+void bench_fail(BenchContext *ctx, const char *reason);
+
+/**
+ * Keep the compiler from optimizing away a computed result.
+ *
+ * @param ptr Address of the value to keep (never dereferenced)
+ */
+static inline void bench_keep(const void *ptr) {
+#ifdef __GNUC__
+    __asm__ volatile("" : : "g"(ptr) : "memory");
+#else
+    static const void *volatile sink;
+    sink = ptr;
+#endif
+}
+
+/* ============================================================
+ * Running
+ * ============================================================ */
+
+/**
+ * Run the selected benchmarks and print a results table to stdout.
+ *
+ * @param cases Benchmark table (borrowed)
+ * @param count Number of entries in cases
+ * @param config Run options, NULL for defaults
+ * @return true if every selected benchmark ran without bench_fail(), no
+ *         allocation-free benchmark allocated, and results were written
+ */
+bool bench_run(const BenchCase *cases, size_t count, const BenchConfig *config);
+
+/**
+ * Parse command-line options into a BenchConfig and run the benchmarks.
+ *
+ * Options: --list, --filter SUBSTR, --only NAME, --iterations N,
+ *          --min-time MS, --repetitions N, --json PATH
+ *
+ * @return EXIT_SUCCESS or EXIT_FAILURE, suitable for returning from main()
+ */
+int bench_main(int argc, char **argv, const BenchCase *cases, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CARBIDE_BENCH_H */
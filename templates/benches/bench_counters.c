@@ -0,0 +1,182 @@
+/**
+ * Hardware performance counters (perf_event_open on Linux).
+ */
+#ifdef __linux__
+#define _DEFAULT_SOURCE  // syscall
+#endif
+
+#include "bench_counters.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* ============================================================
+ * Types
+ * ============================================================ */
+
+static const char *const COUNTER_NAMES[BENCH_COUNTER_COUNT] = {
+    [BENCH_COUNTER_CYCLES] = "cycles",
+    [BENCH_COUNTER_INSTRUCTIONS] = "instructions",
+    [BENCH_COUNTER_CACHE_MISSES] = "cache_misses",
+    [BENCH_COUNTER_BRANCH_MISSES] = "branch_misses",
+};
+
+/* ============================================================
+ * Linux Implementation
+ * ============================================================ */
+
+#ifdef __linux__
+
+static const uint64_t EVENT_CONFIGS[BENCH_COUNTER_COUNT] = {
+    [BENCH_COUNTER_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+    [BENCH_COUNTER_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+    [BENCH_COUNTER_CACHE_MISSES] = PERF_COUNT_HW_CACHE_MISSES,
+    [BENCH_COUNTER_BRANCH_MISSES] = PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+struct BenchCounters {
+    int leader_fd;
+    int fds[BENCH_COUNTER_COUNT];         /* -1 = event not opened */
+    int group_slot[BENCH_COUNTER_COUNT];  /* Position in the group read */
+    int group_size;
+};
+
+/* Layout of read() with PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING */
+typedef struct {
+    uint64_t nr;
+    uint64_t time_enabled;
+    uint64_t time_running;
+    uint64_t values[BENCH_COUNTER_COUNT];
+} GroupReading;
+
+static int open_event(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd == -1 ? 1 : 0;  // Leader gates the whole group
+    attr.exclude_kernel = 1;                  // Allowed up to perf_event_paranoid=2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+    return (int)fd;
+}
+
+BenchCounters *bench_counters_create(void) {
+    BenchCounters *c = calloc(1, sizeof(BenchCounters));
+    if (!c) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    c->leader_fd = -1;
+    int first_errno = 0;
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        c->fds[i] = open_event(EVENT_CONFIGS[i], c->leader_fd);
+        if (c->fds[i] < 0) {
+            // Unsupported events (common in VMs) are skipped, not fatal
+            if (first_errno == 0) first_errno = errno;
+            c->group_slot[i] = -1;
+            continue;
+        }
+        if (c->leader_fd == -1) {
+            c->leader_fd = c->fds[i];
+        }
+        c->group_slot[i] = c->group_size++;
+    }
+
+    if (c->leader_fd == -1) {
+        free(c);
+        errno = first_errno;
+        return NULL;
+    }
+    return c;
+}
+
+void bench_counters_destroy(BenchCounters *counters) {
+    if (!counters) return;
+
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            close(counters->fds[i]);
+        }
+    }
+    free(counters);
+}
+
+void bench_counters_start(BenchCounters *counters) {
+    if (!counters) return;
+
+    ioctl(counters->leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters->leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void bench_counters_stop(BenchCounters *counters, BenchCounterValues *out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!counters) return;
+
+    ioctl(counters->leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    GroupReading reading;
+    ssize_t expected = (ssize_t)(3 + counters->group_size) * (ssize_t)sizeof(uint64_t);
+    if (read(counters->leader_fd, &reading, sizeof(reading)) != expected ||
+        reading.nr != (uint64_t)counters->group_size || reading.time_running == 0) {
+        return;  // Never scheduled: report no values rather than zeros
+    }
+
+    // Scale up if the group shared the PMU with other events
+    double scale = (double)reading.time_enabled / (double)reading.time_running;
+    for (int i = 0; i < BENCH_COUNTER_COUNT; i++) {
+        int slot = counters->group_slot[i];
+        if (slot < 0) continue;
+        out->values[i] = (uint64_t)((double)reading.values[slot] * scale);
+        out->has_value[i] = true;
+    }
+}
+
+#else /* !__linux__ */
+
+/* ============================================================
+ * Fallback Implementation
+ * ============================================================ */
+
+BenchCounters *bench_counters_create(void) {
+    errno = ENOTSUP;
+    return NULL;
+}
+
+void bench_counters_destroy(BenchCounters *counters) {
+    (void)counters;
+}
+
+void bench_counters_start(BenchCounters *counters) {
+    (void)counters;
+}
+
+void bench_counters_stop(BenchCounters *counters, BenchCounterValues *out) {
+    (void)counters;
+    if (out) memset(out, 0, sizeof(*out));
+}
+
+#endif /* __linux__ */
+
+/* ============================================================
+ * Public Functions
+ * ============================================================ */
+
+const char *bench_counter_get_name(BenchCounter counter) {
+    if ((int)counter < 0 || counter >= BENCH_COUNTER_COUNT) return "unknown";
+    return COUNTER_NAMES[counter];
+}
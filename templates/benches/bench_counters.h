@@ -0,0 +1,79 @@
+/**
+ * Hardware performance counters for the benchmark harness.
+ *
+ * Linux uses a single perf_event_open group so all counters cover the
+ * same instructions. Other platforms, and Linux without permission to
+ * open counters, get no counters and the harness reports time only.
+ *
+ * Thread-safe: No (counts the calling thread only)
+ */
+#ifndef CARBIDE_BENCH_COUNTERS_H
+#define CARBIDE_BENCH_COUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ * Types
+ * ============================================================ */
+
+typedef enum {
+    BENCH_COUNTER_CYCLES = 0,
+    BENCH_COUNTER_INSTRUCTIONS,
+    BENCH_COUNTER_CACHE_MISSES,
+    BENCH_COUNTER_BRANCH_MISSES,
+    BENCH_COUNTER_COUNT
+} BenchCounter;
+
+typedef struct BenchCounters BenchCounters;
+
+typedef struct {
+    uint64_t values[BENCH_COUNTER_COUNT];
+    bool has_value[BENCH_COUNTER_COUNT];  /* false = not supported or not scheduled */
+} BenchCounterValues;
+
+/* ============================================================
+ * Lifecycle
+ * ============================================================ */
+
+/**
+ * Open the counter group for the calling thread.
+ *
+ * Events the CPU or kernel does not support are skipped individually.
+ *
+ * @return Counters, or NULL if none could be opened (errno describes why;
+ *         EACCES/EPERM usually means kernel.perf_event_paranoid > 2)
+ */
+BenchCounters *bench_counters_create(void);
+
+/** Close the counter group. Safe to call with NULL. */
+void bench_counters_destroy(BenchCounters *counters);
+
+/* ============================================================
+ * Measurement
+ * ============================================================ */
+
+/** Reset and start counting. No-op if counters is NULL. */
+void bench_counters_start(BenchCounters *counters);
+
+/**
+ * Stop counting and read the group.
+ *
+ * Values are scaled if the kernel multiplexed the group.
+ *
+ * @param out Receives the counts; has_value is all false if counters is NULL
+ */
+void bench_counters_stop(BenchCounters *counters, BenchCounterValues *out);
+
+/** Short name of a counter for reports ("cycles", "instructions", ...). */
+const char *bench_counter_get_name(BenchCounter counter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CARBIDE_BENCH_COUNTERS_H */
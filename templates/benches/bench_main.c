@@ -0,0 +1,102 @@
+/**
+ * Benchmark entry point.
+ *
+ * Add one function per benchmark and list it in BENCHES.
+ */
+#include "bench.h"
+#include "histogram.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* ============================================================
+ * Benchmarks
+ * ============================================================ */
+
+#define SUM_COUNT 4096
+
+static void bench_sum_u32(BenchContext *ctx, void *user_data) {
+    (void)user_data;
+
+    uint32_t *values = calloc(SUM_COUNT, sizeof(uint32_t));
+    if (!values) {
+        bench_fail(ctx, "out of memory");
+        return;
+    }
+    for (size_t i = 0; i < SUM_COUNT; i++) {
+        values[i] = (uint32_t)i;
+    }
+
+    bench_begin(ctx);
+    for (uint64_t n = 0; n < bench_get_iterations(ctx); n++) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < SUM_COUNT; i++) {
+            sum += values[i];
+        }
+        bench_keep(&sum);
+    }
+    bench_end(ctx);
+
+    free(values);
+}
+
+/* Same work, timed per operation to report latency percentiles */
+static void bench_sum_u32_latency(BenchContext *ctx, void *user_data) {
+    (void)user_data;
+
+    uint32_t *values = calloc(SUM_COUNT, sizeof(uint32_t));
+    if (!values) {
+        bench_fail(ctx, "out of memory");
+        return;
+    }
+    for (size_t i = 0; i < SUM_COUNT; i++) {
+        values[i] = (uint32_t)i;
+    }
+
+    bench_begin(ctx);
+    for (uint64_t n = 0; n < bench_get_iterations(ctx); n++) {
+        uint64_t start = bench_now_ns();
+        uint64_t sum = 0;
+        for (size_t i = 0; i < SUM_COUNT; i++) {
+            sum += values[i];
+        }
+        bench_keep(&sum);
+        bench_record_latency(ctx, bench_now_ns() - start);
+    }
+    bench_end(ctx);
+
+    free(values);
+}
+
+static void bench_histogram_record(BenchContext *ctx, void *user_data) {
+    (void)user_data;
+
+    Histogram *histogram = histogram_create(NULL);
+    if (!histogram) {
+        bench_fail(ctx, "histogram_create failed");
+        return;
+    }
+
+    bench_begin(ctx);
+    for (uint64_t n = 0; n < bench_get_iterations(ctx); n++) {
+        // Spread values across buckets like real latencies would
+        histogram_record(histogram, (n * 2654435761u) & 0xfffff);
+    }
+    bench_end(ctx);
+
+    bench_keep(histogram);
+    histogram_destroy(histogram);
+}
+
+static const BenchCase BENCHES[] = {
+    {.name = "sum_u32", .func = bench_sum_u32, .user_data = NULL, .is_alloc_free = true},
+    {.name = "sum_u32_latency", .func = bench_sum_u32_latency, .user_data = NULL,
+     .is_alloc_free = true},
+    {.name = "histogram_record", .func = bench_histogram_record, .user_data = NULL,
+     .is_alloc_free = true},
+};
+
+int main(int argc, char **argv) {
+    return bench_main(argc, argv, BENCHES, sizeof(BENCHES) / sizeof(BENCHES[0]));
+}
@@ -0,0 +1,158 @@
+/**
+ * Memory metrics: allocator hooks, page faults and peak RSS.
+ */
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L  // getrusage
+#endif
+
+#include "bench_memory.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+/* ============================================================
+ * Allocator Hooks
+ * ============================================================ */
+
+static _Atomic uint64_t g_alloc_count;
+static _Atomic uint64_t g_alloc_bytes;
+
+static void record_alloc(const void *ptr, size_t size) {
+    if (!ptr) return;  // Failed allocations are not counted
+    atomic_fetch_add_explicit(&g_alloc_count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&g_alloc_bytes, size, memory_order_relaxed);
+}
+
+#ifdef BENCH_HAVE_ALLOC_HOOKS
+
+// Provided by the linker for each --wrap=symbol
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__real_aligned_alloc(size_t alignment, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+void *__wrap_aligned_alloc(size_t alignment, size_t size);
+char *__wrap_strdup(const char *str);
+void __wrap_free(void *ptr);
+
+void *__wrap_malloc(size_t size) {
+    void *ptr = __real_malloc(size);
+    record_alloc(ptr, size);
+    return ptr;
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    void *ptr = __real_calloc(count, size);
+    // calloc already rejected count * size overflow if ptr is non-NULL
+    record_alloc(ptr, count * size);
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    void *new_ptr = __real_realloc(ptr, size);
+    record_alloc(new_ptr, size);
+    return new_ptr;
+}
+
+void *__wrap_aligned_alloc(size_t alignment, size_t size) {
+    void *ptr = __real_aligned_alloc(alignment, size);
+    record_alloc(ptr, size);
+    return ptr;
+}
+
+// libc's own strdup would call the unwrapped malloc
+char *__wrap_strdup(const char *str) {
+    size_t size = strlen(str) + 1;
+    char *copy = __wrap_malloc(size);
+    if (copy) {
+        memcpy(copy, str, size);
+    }
+    return copy;
+}
+
+void __wrap_free(void *ptr) {
+    __real_free(ptr);
+}
+
+#endif /* BENCH_HAVE_ALLOC_HOOKS */
+
+/* ============================================================
+ * Public Functions
+ * ============================================================ */
+
+bool bench_memory_has_alloc_hooks(void) {
+#ifdef BENCH_HAVE_ALLOC_HOOKS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void bench_memory_snapshot(BenchMemorySnapshot *out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+
+    out->has_alloc = bench_memory_has_alloc_hooks();
+    out->alloc_count = atomic_load_explicit(&g_alloc_count, memory_order_relaxed);
+    out->alloc_bytes = atomic_load_explicit(&g_alloc_bytes, memory_order_relaxed);
+
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        out->page_faults = (uint64_t)usage.ru_minflt + (uint64_t)usage.ru_majflt;
+        out->has_page_faults = true;
+    }
+#endif
+}
+
+bool bench_memory_reset_peak_rss(void) {
+#ifdef __linux__
+    // "5" resets VmHWM to the current RSS (Linux 4.0+)
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (!f) return false;
+    bool is_ok = fputs("5", f) >= 0;
+    if (fclose(f) != 0) is_ok = false;
+    return is_ok;
+#else
+    return false;
+#endif
+}
+
+uint64_t bench_memory_get_peak_rss_kb(void) {
+#ifdef __linux__
+    FILE *f = fopen("/proc/self/status", "r");
+    if (f) {
+        char line[256];
+        unsigned long long kb = 0;
+        bool is_found = false;
+        while (!is_found && fgets(line, sizeof(line), f)) {
+            is_found = sscanf(line, "VmHWM: %llu kB", &kb) == 1;
+        }
+        fclose(f);
+        if (is_found) return (uint64_t)kb;
+    }
+#endif
+
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0 && usage.ru_maxrss > 0) {
+#ifdef __APPLE__
+        return (uint64_t)usage.ru_maxrss / 1024;  // Bytes on macOS
+#else
+        return (uint64_t)usage.ru_maxrss;          // KiB elsewhere
+#endif
+    }
+#endif
+    return 0;
+}
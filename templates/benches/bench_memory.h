@@ -0,0 +1,60 @@
+/**
+ * Memory metrics for the benchmark harness.
+ *
+ * Allocation counts come from link-time allocator hooks: on GNU
+ * toolchains the Makefile links benchmarks with --wrap=malloc (and
+ * calloc, realloc, free, strdup, aligned_alloc), which routes every
+ * allocation made by project and benchmark code through this module.
+ * Allocations made inside libc itself are not counted.
+ *
+ * Thread-safe: Yes (allocation counters are atomic)
+ */
+#ifndef CARBIDE_BENCH_MEMORY_H
+#define CARBIDE_BENCH_MEMORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ * Types
+ * ============================================================ */
+
+typedef struct {
+    uint64_t alloc_count;    /* Successful allocation calls since start */
+    uint64_t alloc_bytes;    /* Bytes requested by those calls */
+    uint64_t page_faults;    /* Minor + major faults since start */
+    bool has_alloc;          /* false = allocator hooks not linked */
+    bool has_page_faults;    /* false = platform does not report faults */
+} BenchMemorySnapshot;
+
+/* ============================================================
+ * Operations
+ * ============================================================ */
+
+/** Whether allocation counting is active in this build. */
+bool bench_memory_has_alloc_hooks(void);
+
+/** Capture current cumulative allocation and page-fault counts. */
+void bench_memory_snapshot(BenchMemorySnapshot *out);
+
+/**
+ * Reset the process peak RSS so the next reading covers only what runs
+ * after this call.
+ *
+ * @return false if the platform cannot reset it (readings then report the
+ *         peak since process start)
+ */
+bool bench_memory_reset_peak_rss(void);
+
+/** Peak resident set size in KiB, or 0 if unknown. */
+uint64_t bench_memory_get_peak_rss_kb(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CARBIDE_BENCH_MEMORY_H */
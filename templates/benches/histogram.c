@@ -0,0 +1,483 @@
+/**
+ * HDR latency histogram implementation.
+ *
+ * Layout follows HdrHistogram: values are split into power-of-two
+ * buckets, each divided into sub-buckets fine enough for the requested
+ * significant figures. The first bucket's lower half is shared, so each
+ * later bucket only stores its upper half.
+ */
+#include "histogram.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================
+ * Types
+ * ============================================================ */
+
+#define HISTOGRAM_MAGIC 0x52444843u  /* "CHDR" little-endian */
+#define HISTOGRAM_VERSION 1u
+#define HISTOGRAM_HEADER_SIZE 56u
+#define HISTOGRAM_MAX_VARINT 10u
+
+struct Histogram {
+    uint64_t lowest_trackable;
+    uint64_t highest_trackable;
+    int significant_figures;
+    int unit_magnitude;
+    int sub_bucket_half_count_magnitude;
+    int32_t sub_bucket_count;
+    int32_t sub_bucket_half_count;
+    uint64_t sub_bucket_mask;
+    int32_t bucket_count;
+    int32_t counts_len;
+    _Atomic uint64_t min_value;    /* UINT64_MAX when empty */
+    _Atomic uint64_t max_value;
+    _Atomic uint64_t clamped_count;
+    _Atomic uint64_t counts[];
+};
+
+/* ============================================================
+ * Private Functions
+ * ============================================================ */
+
+/* Single-writer increment: no lock prefix, but never torn for readers */
+static void add_relaxed(_Atomic uint64_t *target, uint64_t amount) {
+    uint64_t value = atomic_load_explicit(target, memory_order_relaxed);
+    atomic_store_explicit(target, value + amount, memory_order_relaxed);
+}
+
+static uint64_t load_relaxed(const _Atomic uint64_t *source) {
+    return atomic_load_explicit((_Atomic uint64_t *)source, memory_order_relaxed);
+}
+
+static int count_leading_zeros(uint64_t value) {
+#ifdef __GNUC__
+    return value ? __builtin_clzll(value) : 64;
+#else
+    int count = 0;
+    for (uint64_t bit = (uint64_t)1 << 63; bit && !(value & bit); bit >>= 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+static int32_t get_bucket_index(const Histogram *h, uint64_t value) {
+    int pow2_ceiling = 64 - count_leading_zeros(value | h->sub_bucket_mask);
+    return pow2_ceiling - h->unit_magnitude - (h->sub_bucket_half_count_magnitude + 1);
+}
+
+static int32_t get_sub_bucket_index(const Histogram *h, uint64_t value, int32_t bucket) {
+    return (int32_t)(value >> (bucket + h->unit_magnitude));
+}
+
+static int32_t get_counts_index(const Histogram *h, uint64_t value) {
+    int32_t bucket = get_bucket_index(h, value);
+    int32_t sub_bucket = get_sub_bucket_index(h, value, bucket);
+    int32_t bucket_base = (bucket + 1) << h->sub_bucket_half_count_magnitude;
+    return bucket_base + (sub_bucket - h->sub_bucket_half_count);
+}
+
+static uint64_t get_value_at_index(const Histogram *h, int32_t index) {
+    int32_t bucket = (index >> h->sub_bucket_half_count_magnitude) - 1;
+    int32_t sub_bucket = (index & (h->sub_bucket_half_count - 1)) + h->sub_bucket_half_count;
+    if (bucket < 0) {
+        sub_bucket -= h->sub_bucket_half_count;
+        bucket = 0;
+    }
+    return (uint64_t)sub_bucket << (bucket + h->unit_magnitude);
+}
+
+/* Width of the range of values that share value's counter */
+static uint64_t get_equivalent_range(const Histogram *h, uint64_t value) {
+    int32_t bucket = get_bucket_index(h, value);
+    int32_t sub_bucket = get_sub_bucket_index(h, value, bucket);
+    int32_t adjusted = sub_bucket >= h->sub_bucket_count ? bucket + 1 : bucket;
+    return (uint64_t)1 << (h->unit_magnitude + adjusted);
+}
+
+static uint64_t get_highest_equivalent(const Histogram *h, uint64_t value) {
+    return value + get_equivalent_range(h, value) - 1;
+}
+
+static uint64_t get_median_equivalent(const Histogram *h, uint64_t value) {
+    return value + (get_equivalent_range(h, value) >> 1);
+}
+
+static bool is_same_layout(const Histogram *a, const Histogram *b) {
+    return a->unit_magnitude == b->unit_magnitude &&
+           a->sub_bucket_count == b->sub_bucket_count && a->counts_len == b->counts_len;
+}
+
+static void write_u32_le(uint8_t *buf, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        buf[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void write_u64_le(uint8_t *buf, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        buf[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint32_t read_u32_le(const uint8_t *buf) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)buf[i] << (8 * i);
+    }
+    return value;
+}
+
+static uint64_t read_u64_le(const uint8_t *buf) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= (uint64_t)buf[i] << (8 * i);
+    }
+    return value;
+}
+
+/* LEB128; writes nothing when out is NULL. Returns bytes used. */
+static size_t write_varint(uint8_t *out, uint64_t value) {
+    size_t n = 0;
+    do {
+        uint8_t byte = (uint8_t)(value & 0x7f);
+        value >>= 7;
+        if (value) byte |= 0x80;
+        if (out) out[n] = byte;
+        n++;
+    } while (value);
+    return n;
+}
+
+/* Returns bytes consumed, or 0 if malformed or truncated */
+static size_t read_varint(const uint8_t *data, size_t size, uint64_t *out) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size && i < HISTOGRAM_MAX_VARINT; i++) {
+        uint64_t part = data[i] & 0x7f;
+        if (i == HISTOGRAM_MAX_VARINT - 1 && part > 1) return 0;  // > 64 bits
+        value |= part << (7 * i);
+        if (!(data[i] & 0x80)) {
+            *out = value;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/* Append one varint if it fits; *size past capacity marks the payload as not fitting */
+static void append_varint(uint8_t *out, size_t capacity, size_t *size, uint64_t value) {
+    size_t n = write_varint(NULL, value);
+    if (out && *size <= capacity && n <= capacity - *size) write_varint(out + *size, value);
+    *size += n;
+}
+
+/*
+ * Payload: one varint per entry. Even values 2c are a count c > 0 for
+ * the next index; odd values 2k - 1 skip k empty indexes.
+ * Writes nothing when out is NULL, and never past capacity bytes of out.
+ * Returns payload size, which exceeds capacity if it did not fit.
+ */
+static size_t encode_counts(const Histogram *h, uint8_t *out, size_t capacity) {
+    size_t size = 0;
+    uint64_t zero_run = 0;
+
+    for (int32_t i = 0; i < h->counts_len; i++) {
+        uint64_t count = load_relaxed(&h->counts[i]);
+        if (count == 0) {
+            zero_run++;
+            continue;
+        }
+        if (zero_run > 0) {
+            append_varint(out, capacity, &size, zero_run * 2 - 1);
+            zero_run = 0;
+        }
+        // Counts above 2^63 cannot be encoded; saturate rather than wrap
+        if (count > UINT64_MAX / 2) count = UINT64_MAX / 2;
+        append_varint(out, capacity, &size, count * 2);
+    }
+    return size;
+}
+
+/* ============================================================
+ * Public Functions
+ * ============================================================ */
+
+Histogram *histogram_create(const HistogramConfig *config) {
+    HistogramConfig default_config = HISTOGRAM_CONFIG_DEFAULT;
+    if (!config) {
+        config = &default_config;
+    }
+
+    if (config->lowest_trackable < 1 || config->significant_figures < 1 ||
+        config->significant_figures > 5 ||
+        config->highest_trackable / 2 < config->lowest_trackable ||
+        config->highest_trackable > (uint64_t)INT64_MAX / 2) {
+        return NULL;
+    }
+
+    // Sub-buckets needed so that adjacent values differ by < 1 unit in the
+    // last significant figure: 2 * 10^figures, rounded up to a power of two
+    uint64_t largest_single_unit = 2;
+    for (int i = 0; i < config->significant_figures; i++) {
+        largest_single_unit *= 10;
+    }
+    int sub_bucket_count_magnitude = 64 - count_leading_zeros(largest_single_unit - 1);
+    int unit_magnitude = 63 - count_leading_zeros(config->lowest_trackable);
+    int32_t sub_bucket_count = (int32_t)1 << sub_bucket_count_magnitude;
+
+    int32_t bucket_count = 1;
+    uint64_t smallest_untrackable = (uint64_t)sub_bucket_count << unit_magnitude;
+    while (smallest_untrackable <= config->highest_trackable) {
+        smallest_untrackable <<= 1;
+        bucket_count++;
+    }
+
+    int32_t sub_bucket_half_count = sub_bucket_count / 2;
+    int32_t counts_len = (bucket_count + 1) * sub_bucket_half_count;
+
+    Histogram *h = calloc(1, sizeof(Histogram) + (size_t)counts_len * sizeof(_Atomic uint64_t));
+    if (!h) return NULL;
+
+    h->lowest_trackable = config->lowest_trackable;
+    h->highest_trackable = config->highest_trackable;
+    h->significant_figures = config->significant_figures;
+    h->unit_magnitude = unit_magnitude;
+    h->sub_bucket_half_count_magnitude = sub_bucket_count_magnitude - 1;
+    h->sub_bucket_count = sub_bucket_count;
+    h->sub_bucket_half_count = sub_bucket_half_count;
+    h->sub_bucket_mask = (uint64_t)(sub_bucket_count - 1) << unit_magnitude;
+    h->bucket_count = bucket_count;
+    h->counts_len = counts_len;
+    atomic_init(&h->min_value, UINT64_MAX);
+    atomic_init(&h->max_value, 0);
+    atomic_init(&h->clamped_count, 0);
+    return h;
+}
+
+void histogram_destroy(Histogram *histogram) {
+    free(histogram);
+}
+
+void histogram_reset(Histogram *histogram) {
+    if (!histogram) return;
+
+    for (int32_t i = 0; i < histogram->counts_len; i++) {
+        atomic_store_explicit(&histogram->counts[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&histogram->min_value, UINT64_MAX, memory_order_relaxed);
+    atomic_store_explicit(&histogram->max_value, 0, memory_order_relaxed);
+    atomic_store_explicit(&histogram->clamped_count, 0, memory_order_relaxed);
+}
+
+size_t histogram_get_memory_size(const Histogram *histogram) {
+    if (!histogram) return 0;
+    return sizeof(Histogram) + (size_t)histogram->counts_len * sizeof(_Atomic uint64_t);
+}
+
+void histogram_record(Histogram *histogram, uint64_t value) {
+    histogram_record_n(histogram, value, 1);
+}
+
+void histogram_record_n(Histogram *histogram, uint64_t value, uint64_t count) {
+    if (!histogram || count == 0) return;
+
+    if (value > histogram->highest_trackable) {
+        value = histogram->highest_trackable;
+        add_relaxed(&histogram->clamped_count, count);
+    }
+
+    add_relaxed(&histogram->counts[get_counts_index(histogram, value)], count);
+
+    if (value < load_relaxed(&histogram->min_value)) {
+        atomic_store_explicit(&histogram->min_value, value, memory_order_relaxed);
+    }
+    if (value > load_relaxed(&histogram->max_value)) {
+        atomic_store_explicit(&histogram->max_value, value, memory_order_relaxed);
+    }
+}
+
+bool histogram_merge(Histogram *dst, const Histogram *src) {
+    if (!dst || !src) return false;
+
+    if (is_same_layout(dst, src)) {
+        for (int32_t i = 0; i < src->counts_len; i++) {
+            uint64_t count = load_relaxed(&src->counts[i]);
+            if (count) add_relaxed(&dst->counts[i], count);
+        }
+
+        uint64_t src_min = load_relaxed(&src->min_value);
+        uint64_t src_max = load_relaxed(&src->max_value);
+        if (src_min < load_relaxed(&dst->min_value)) {
+            atomic_store_explicit(&dst->min_value, src_min, memory_order_relaxed);
+        }
+        if (src_max > load_relaxed(&dst->max_value)) {
+            atomic_store_explicit(&dst->max_value, src_max, memory_order_relaxed);
+        }
+    } else {
+        for (int32_t i = 0; i < src->counts_len; i++) {
+            uint64_t count = load_relaxed(&src->counts[i]);
+            if (count) {
+                uint64_t value = get_value_at_index(src, i);
+                histogram_record_n(dst, get_median_equivalent(src, value), count);
+            }
+        }
+    }
+
+    add_relaxed(&dst->clamped_count, load_relaxed(&src->clamped_count));
+    return true;
+}
+
+uint64_t histogram_get_total_count(const Histogram *histogram) {
+    if (!histogram) return 0;
+
+    uint64_t total = 0;
+    for (int32_t i = 0; i < histogram->counts_len; i++) {
+        total += load_relaxed(&histogram->counts[i]);
+    }
+    return total;
+}
+
+uint64_t histogram_get_clamped_count(const Histogram *histogram) {
+    return histogram ? load_relaxed(&histogram->clamped_count) : 0;
+}
+
+uint64_t histogram_get_min(const Histogram *histogram) {
+    if (!histogram) return 0;
+    uint64_t min = load_relaxed(&histogram->min_value);
+    return min == UINT64_MAX ? 0 : min;
+}
+
+uint64_t histogram_get_max(const Histogram *histogram) {
+    return histogram ? load_relaxed(&histogram->max_value) : 0;
+}
+
+double histogram_get_mean(const Histogram *histogram) {
+    if (!histogram) return 0.0;
+
+    double sum = 0.0;
+    uint64_t total = 0;
+    for (int32_t i = 0; i < histogram->counts_len; i++) {
+        uint64_t count = load_relaxed(&histogram->counts[i]);
+        if (count) {
+            uint64_t value = get_value_at_index(histogram, i);
+            sum += (double)get_median_equivalent(histogram, value) * (double)count;
+            total += count;
+        }
+    }
+    return total ? sum / (double)total : 0.0;
+}
+
+uint64_t histogram_get_value_at_percentile(const Histogram *histogram, double percentile) {
+    if (!histogram) return 0;
+
+    uint64_t total = histogram_get_total_count(histogram);
+    if (total == 0) return 0;
+
+    if (percentile < 0.0) percentile = 0.0;
+    if (percentile > 100.0) percentile = 100.0;
+
+    // Rank of the value, rounded up, at least 1 (no libm ceil needed)
+    double exact_rank = percentile / 100.0 * (double)total;
+    uint64_t rank = (uint64_t)exact_rank;
+    if ((double)rank < exact_rank) rank++;
+    if (rank == 0) rank = 1;
+
+    uint64_t cumulative = 0;
+    uint64_t max = histogram_get_max(histogram);
+    for (int32_t i = 0; i < histogram->counts_len; i++) {
+        cumulative += load_relaxed(&histogram->counts[i]);
+        if (cumulative >= rank) {
+            uint64_t value = get_highest_equivalent(histogram, get_value_at_index(histogram, i));
+            return value < max ? value : max;
+        }
+    }
+    return max;
+}
+
+size_t histogram_get_serialized_size(const Histogram *histogram) {
+    if (!histogram) return 0;
+    return HISTOGRAM_HEADER_SIZE + encode_counts(histogram, NULL, 0);
+}
+
+bool histogram_serialize(const Histogram *histogram, uint8_t *buffer, size_t size,
+                         size_t *out_written) {
+    if (out_written) *out_written = 0;
+    if (!histogram || !buffer) return false;
+
+    // Encode in place, bounded by the buffer: counts may grow while another
+    // thread records, so the payload can outgrow any size measured before
+    if (size < HISTOGRAM_HEADER_SIZE) return false;
+    size_t capacity = size - HISTOGRAM_HEADER_SIZE;
+    size_t written = encode_counts(histogram, buffer + HISTOGRAM_HEADER_SIZE, capacity);
+    if (written > capacity || written > UINT32_MAX) {
+        return false;  // Too small, or grew while encoding; caller can retry
+    }
+
+    write_u32_le(buffer + 0, HISTOGRAM_MAGIC);
+    write_u32_le(buffer + 4, HISTOGRAM_VERSION);
+    write_u64_le(buffer + 8, histogram->lowest_trackable);
+    write_u64_le(buffer + 16, histogram->highest_trackable);
+    write_u32_le(buffer + 24, (uint32_t)histogram->significant_figures);
+    write_u32_le(buffer + 28, (uint32_t)written);
+    write_u64_le(buffer + 32, load_relaxed(&histogram->min_value));
+    write_u64_le(buffer + 40, load_relaxed(&histogram->max_value));
+    write_u64_le(buffer + 48, load_relaxed(&histogram->clamped_count));
+
+    if (out_written) *out_written = HISTOGRAM_HEADER_SIZE + written;
+    return true;
+}
+
+Histogram *histogram_deserialize(const uint8_t *data, size_t size) {
+    if (!data || size < HISTOGRAM_HEADER_SIZE) return NULL;
+    if (read_u32_le(data) != HISTOGRAM_MAGIC || read_u32_le(data + 4) != HISTOGRAM_VERSION) {
+        return NULL;
+    }
+
+    uint32_t figures = read_u32_le(data + 24);
+    uint32_t payload_size = read_u32_le(data + 28);
+    if (figures > 5 || payload_size > size - HISTOGRAM_HEADER_SIZE) return NULL;
+
+    HistogramConfig config = {
+        .lowest_trackable = read_u64_le(data + 8),
+        .highest_trackable = read_u64_le(data + 16),
+        .significant_figures = (int)figures,
+    };
+    Histogram *h = histogram_create(&config);
+    if (!h) return NULL;  // Config validated by create
+
+    const uint8_t *cursor = data + HISTOGRAM_HEADER_SIZE;
+    size_t remaining = payload_size;
+    uint64_t index = 0;
+    while (remaining > 0) {
+        uint64_t entry = 0;
+        size_t used = read_varint(cursor, remaining, &entry);
+        if (used == 0 || entry == 0) goto malformed;
+        cursor += used;
+        remaining -= used;
+
+        if (entry & 1) {
+            uint64_t run = (entry + 1) / 2;
+            if (run > (uint64_t)h->counts_len - index) goto malformed;
+            index += run;
+        } else {
+            if (index >= (uint64_t)h->counts_len) goto malformed;
+            atomic_store_explicit(&h->counts[index], entry / 2, memory_order_relaxed);
+            index++;
+        }
+    }
+
+    uint64_t min = read_u64_le(data + 32);
+    uint64_t max = read_u64_le(data + 40);
+    if (max > h->highest_trackable || (min != UINT64_MAX && min > max)) goto malformed;
+    atomic_store_explicit(&h->min_value, min, memory_order_relaxed);
+    atomic_store_explicit(&h->max_value, max, memory_order_relaxed);
+    atomic_store_explicit(&h->clamped_count, read_u64_le(data + 48), memory_order_relaxed);
+    return h;
+
+malformed:
+    histogram_destroy(h);
+    return NULL;
+}
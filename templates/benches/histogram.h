@@ -0,0 +1,155 @@
+/**
+ * HDR latency histogram.
+ *
+ * Records integer values (typically nanoseconds) with a fixed relative
+ * precision across a fixed range, in memory allocated once at create
+ * time. Recording is O(1) and never allocates.
+ *
+ * Self-contained: used by the benchmark harness, and can be moved to
+ * src/ for runtime instrumentation (benchmarks also compile with -Isrc).
+ *
+ * Thread safety: each histogram has ONE recording thread. Any thread may
+ * read, query, merge from or serialize it concurrently (results reflect
+ * a recent, possibly partial, state). For multi-threaded recording give
+ * each thread its own histogram and merge them into an aggregate.
+ */
+#ifndef CARBIDE_HISTOGRAM_H
+#define CARBIDE_HISTOGRAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================
+ * Types
+ * ============================================================ */
+
+typedef struct Histogram Histogram;
+
+typedef struct {
+    uint64_t lowest_trackable;    /* Smallest distinguishable value, >= 1 */
+    uint64_t highest_trackable;   /* Larger values are clamped to this */
+    int significant_figures;      /* Decimal precision, 1..5 */
+} HistogramConfig;
+
+/* 1 ns to 60 s with 3 significant figures (0.1% error), about 210 KiB */
+#define HISTOGRAM_CONFIG_DEFAULT { \
+    .lowest_trackable = 1, \
+    .highest_trackable = 60000000000ull, \
+    .significant_figures = 3 \
+}
+
+/* ============================================================
+ * Lifecycle
+ * ============================================================ */
+
+/**
+ * Create an empty histogram.
+ *
+ * @param config Range and precision, NULL for defaults
+ * @return New histogram, or NULL if config is invalid (lowest < 1,
+ *         highest < 2 * lowest, significant_figures outside 1..5)
+ *         or allocation fails
+ */
+Histogram *histogram_create(const HistogramConfig *config);
+
+/** Destroy a histogram. Safe to call with NULL. */
+void histogram_destroy(Histogram *histogram);
+
+/**
+ * Clear all recorded values.
+ * Thread-safe: No (the recording thread must not record concurrently)
+ */
+void histogram_reset(Histogram *histogram);
+
+/** Bytes used by the histogram including its counts array. */
+size_t histogram_get_memory_size(const Histogram *histogram);
+
+/* ============================================================
+ * Recording
+ * ============================================================ */
+
+/**
+ * Record one value. Values above highest_trackable are recorded as
+ * highest_trackable and counted by histogram_get_clamped_count().
+ * Thread-safe: Owning thread only
+ */
+void histogram_record(Histogram *histogram, uint64_t value);
+
+/** Record the same value count times. Thread-safe: Owning thread only */
+void histogram_record_n(Histogram *histogram, uint64_t value, uint64_t count);
+
+/**
+ * Add all values from src into dst.
+ *
+ * Histograms with different configs are merged value by value, at the
+ * precision of the coarser one.
+ * Thread-safe: dst's owning thread only; src may be recording concurrently
+ *
+ * @return false if histogram is NULL
+ */
+bool histogram_merge(Histogram *dst, const Histogram *src);
+
+/* ============================================================
+ * Queries
+ * ============================================================ */
+
+uint64_t histogram_get_total_count(const Histogram *histogram);
+uint64_t histogram_get_clamped_count(const Histogram *histogram);
+
+/** Smallest recorded value, or 0 if empty. */
+uint64_t histogram_get_min(const Histogram *histogram);
+
+/** Largest recorded value, or 0 if empty. */
+uint64_t histogram_get_max(const Histogram *histogram);
+
+/** Mean of recorded values (at histogram precision), or 0.0 if empty. */
+double histogram_get_mean(const Histogram *histogram);
+
+/**
+ * Value at or below which the given percentage of values fall.
+ *
+ * @param percentile 0.0 to 100.0 (e.g. 99.9); clamped to that range
+ * @return Value within the histogram's precision, or 0 if empty
+ */
+uint64_t histogram_get_value_at_percentile(const Histogram *histogram, double percentile);
+
+/* ============================================================
+ * Serialization
+ * ============================================================ */
+
+/**
+ * Exact number of bytes histogram_serialize() will write, unless another
+ * thread records a value into an empty bucket in between.
+ */
+size_t histogram_get_serialized_size(const Histogram *histogram);
+
+/**
+ * Write a compact, portable (little-endian, run-length encoded) copy.
+ *
+ * @param buffer Destination
+ * @param size Capacity of buffer
+ * @param out_written Receives bytes written (may be NULL)
+ * @return false if histogram or buffer is NULL or size is too small; never
+ *         writes past size, even while other threads record
+ */
+bool histogram_serialize(const Histogram *histogram, uint8_t *buffer, size_t size,
+                         size_t *out_written);
+
+/**
+ * Create a histogram from serialized data. The input is fully validated.
+ *
+ * @return New histogram (caller must destroy), or NULL if data is
+ *         malformed, truncated or allocation fails
+ */
+Histogram *histogram_deserialize(const uint8_t *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CARBIDE_HISTOGRAM_H */
@@ -0,0 +1,82 @@
+# Carbide benchmark comparison report
+#
+# Compares two JSON files written by the benchmark harness (--json) and
+# shows, per benchmark, how time changed next to the hardware counters
+# that explain why. Used by `make bench-compare`.
+#
+# Usage: awk -f bench-compare.awk BASELINE.json CURRENT.json
+#
+# The harness writes one benchmark object per line, so each line is
+# parsed independently. Counters that are null in either file print "-",
+# as does p99 latency for benchmarks that do not record it.
+#
+# Exits 1 if a benchmark marked allocation-free ("alloc_free": true)
+# allocates more per iteration than in the baseline.
+
+# Value of "key" on the current line, or "" if missing or null
+function field(line, key,    pattern, value) {
+    pattern = "\"" key "\": [^,}]*"
+    if (!match(line, pattern)) return ""
+    value = substr(line, RSTART + length(key) + 4, RLENGTH - length(key) - 4)
+    gsub(/"/, "", value)
+    return value == "null" ? "" : value
+}
+
+function delta(old, new) {
+    if (old == "" || new == "" || old + 0 == 0) return "-"
+    return sprintf("%+.1f%%", (new - old) * 100 / old)
+}
+
+function pair(old, new, fmt) {
+    if (old == "" || new == "") return "-"
+    return sprintf(fmt " -> " fmt, old, new)
+}
+
+BEGIN {
+    printf "%-32s %9s %9s %9s %16s %12s %12s %16s\n", "Benchmark", "time", "p99", "instr",
+        "IPC", "cache-miss", "br-miss", "allocs/op"
+}
+
+!/"name":/ { next }
+
+{
+    name = field($0, "name")
+    if (FNR == NR) {
+        base[name] = $0
+        next
+    }
+
+    seen[name] = 1
+    if (!(name in base)) {
+        printf "%-32s %s\n", name, "(new)"
+        next
+    }
+    old = base[name]
+
+    old_allocs = field(old, "allocs_per_op")
+    new_allocs = field($0, "allocs_per_op")
+    status = ""
+    if (field($0, "alloc_free") == "true" && new_allocs != "" && new_allocs + 0 > old_allocs + 0) {
+        status = "  FAIL (allocation-free)"
+        failed++
+    }
+
+    printf "%-32s %9s %9s %9s %16s %12s %12s %16s%s\n", name,
+        delta(field(old, "ns_per_op_median"), field($0, "ns_per_op_median")),
+        delta(field(old, "latency_p99_ns"), field($0, "latency_p99_ns")),
+        delta(field(old, "instructions_per_op"), field($0, "instructions_per_op")),
+        pair(field(old, "ipc"), field($0, "ipc"), "%.2f"),
+        delta(field(old, "cache_misses_per_op"), field($0, "cache_misses_per_op")),
+        delta(field(old, "branch_misses_per_op"), field($0, "branch_misses_per_op")),
+        pair(old_allocs, new_allocs, "%.1f"), status
+}
+
+END {
+    for (name in base) {
+        if (!(name in seen)) printf "%-32s %s\n", name, "(removed)"
+    }
+    if (failed > 0) {
+        printf "\n%d allocation-free benchmark(s) allocate more than the baseline\n", failed
+        exit 1
+    }
+}
@@ -0,0 +1,147 @@
+#!/bin/sh
+# Carbide instruction-count benchmarks
+#
+# Runs each benchmark in its own process under Cachegrind (or perf stat)
+# and reports per-iteration instructions, L1/LL misses and branch
+# mispredictions. Used by `make bench-icount`.
+#
+# Every benchmark runs twice, with N and 2N fixed iterations; the
+# difference divided by N cancels process startup and benchmark setup,
+# so results depend only on the measured loop.
+#
+# Usage: bench-icount.sh BENCH_BINARY OUTPUT [BASELINE]
+#
+# When BASELINE exists, fails if any benchmark's instruction count grew
+# by more than ICOUNT_TOLERANCE percent.
+#
+# Environment:
+#   ICOUNT_TOOL        cachegrind (default) or perf
+#   ICOUNT_ITERATIONS  N, iterations of the shorter run (default 1000)
+#   ICOUNT_TOLERANCE   Allowed instruction increase in percent (default 0.1)
+
+set -eu
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 BENCH_BINARY OUTPUT [BASELINE]" >&2
+    exit 2
+fi
+
+bench=$1
+output=$2
+baseline=${3:-}
+tool=${ICOUNT_TOOL:-cachegrind}
+iterations=${ICOUNT_ITERATIONS:-1000}
+tolerance=${ICOUNT_TOLERANCE:-0.1}
+
+case $iterations in
+    ''|*[!0-9]*|0) echo "bench-icount: invalid ICOUNT_ITERATIONS ($iterations)" >&2; exit 2 ;;
+esac
+
+case $tool in
+    cachegrind)
+        command -v valgrind >/dev/null 2>&1 || {
+            echo "bench-icount: valgrind not found (install it or use ICOUNT_TOOL=perf)" >&2
+            exit 2
+        } ;;
+    perf)
+        command -v perf >/dev/null 2>&1 || {
+            echo "bench-icount: perf not found" >&2
+            exit 2
+        } ;;
+    *)
+        echo "bench-icount: unknown ICOUNT_TOOL ($tool)" >&2
+        exit 2 ;;
+esac
+
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT INT TERM
+
+# Print "instructions l1_misses ll_misses branch_misses" for one run
+measure() {
+    name=$1
+    count=$2
+    if [ "$tool" = cachegrind ]; then
+        valgrind --tool=cachegrind --cache-sim=yes --branch-sim=yes \
+            --cachegrind-out-file="$tmp/cg.out" \
+            "$bench" --only "$name" --iterations "$count" --repetitions 1 \
+            >/dev/null 2>"$tmp/log" || { cat "$tmp/log" >&2; return 1; }
+        awk '
+            /^events:/  { for (i = 2; i <= NF; i++) event[i - 1] = $i }
+            /^summary:/ { for (i = 2; i <= NF; i++) value[event[i - 1]] = $i }
+            END {
+                printf "%.0f %.0f %.0f %.0f\n", value["Ir"],
+                    value["I1mr"] + value["D1mr"] + value["D1mw"],
+                    value["ILmr"] + value["DLmr"] + value["DLmw"],
+                    value["Bcm"] + value["Bim"]
+            }' "$tmp/cg.out"
+    else
+        perf stat -x, -o "$tmp/perf.csv" \
+            -e instructions:u,L1-dcache-load-misses:u,LLC-load-misses:u,branch-misses:u \
+            "$bench" --only "$name" --iterations "$count" --repetitions 1 \
+            >/dev/null 2>"$tmp/log" || { cat "$tmp/log" >&2; return 1; }
+        awk -F, '
+            /^#/ || NF < 3 { next }
+            {
+                v = ($1 ~ /^[0-9]+$/) ? $1 : 0
+                if ($3 ~ /^instructions/) ins = v
+                else if ($3 ~ /^L1-dcache/) l1 = v
+                else if ($3 ~ /^LLC/) ll = v
+                else if ($3 ~ /^branch-misses/) br = v
+            }
+            END { printf "%.0f %.0f %.0f %.0f\n", ins, l1, ll, br }' "$tmp/perf.csv"
+    fi
+}
+
+names=$("$bench" --list)
+if [ -z "$names" ]; then
+    echo "bench-icount: no benchmarks listed by $bench" >&2
+    exit 1
+fi
+
+{
+    echo "# Carbide instruction counts (tool=$tool, per iteration)"
+    printf '%-40s %16s %12s %12s %14s\n' "# name" instructions l1_misses ll_misses branch_misses
+} >"$output"
+
+for name in $names; do
+    short=$(measure "$name" "$iterations")
+    long=$(measure "$name" $((iterations * 2)))
+    echo "$short $long" | awk -v name="$name" -v n="$iterations" '{
+        printf "%-40s %16.2f %12.2f %12.2f %14.2f\n", name,
+            ($5 - $1) / n, ($6 - $2) / n, ($7 - $3) / n, ($8 - $4) / n
+    }' >>"$output"
+done
+
+cat "$output"
+
+if [ -z "$baseline" ]; then
+    exit 0
+fi
+if [ ! -f "$baseline" ]; then
+    echo
+    echo "No baseline at $baseline; run 'make bench-icount-baseline' to create one."
+    exit 0
+fi
+
+echo
+echo "Comparing against $baseline (tolerance ${tolerance}%):"
+awk -v tolerance="$tolerance" '
+    /^#/ { next }
+    FNR == NR { base[$1] = $2; next }
+    {
+        if (!($1 in base)) {
+            printf "  %-40s %16.2f %10s\n", $1, $2, "new"
+            next
+        }
+        delta = base[$1] > 0 ? ($2 - base[$1]) * 100 / base[$1] : 0
+        status = delta > tolerance ? "FAIL" : "ok"
+        if (status == "FAIL") failed++
+        printf "  %-40s %16.2f %+9.3f%% %s\n", $1, $2, delta, status
+    }
+    END {
+        if (failed > 0) {
+            printf "\n%d benchmark(s) exceeded the %s%% instruction-count tolerance\n", failed, tolerance
+            exit 1
+        }
+        printf "\nInstruction counts within %s%% of baseline\n", tolerance
+    }' "$baseline" "$output"
@@ -0,0 +1,155 @@
+# Carbide vectorization report
+#
+# Aggregates loop-vectorizer remarks per function and source line.
+# Used by `make vec-report`; works with POSIX awk (gawk, mawk, BSD awk).
+#
+# Input: compiler diagnostics of the form "file:line:col: kind: message"
+#   clang: -Rpass=loop-vectorize -Rpass-missed=loop-vectorize
+#          -Rpass-analysis=loop-vectorize
+#   gcc:   -fopt-info-vec-all
+#
+# Variables:
+#   hot - Optional space-separated "function=percent" list (hottest first).
+#         When set, missed loops are only listed for these functions.
+
+BEGIN {
+    hot_count = split(hot, hot_pairs, " ")
+    for (i = 1; i <= hot_count; i++) {
+        eq = index(hot_pairs[i], "=")
+        if (eq > 0) {
+            hot_names[i] = substr(hot_pairs[i], 1, eq - 1)
+            hot_pct[hot_names[i]] = substr(hot_pairs[i], eq + 1) "%"
+        } else {
+            hot_names[i] = hot_pairs[i]
+            hot_pct[hot_names[i]] = "hot"
+        }
+    }
+}
+
+# Map every line of a source file to the enclosing function definition.
+# Definitions are recognized as top-level (column 0) declarators followed
+# by "(" that do not end in ";" - matching the Carbide brace style.
+function load_functions(file,    line, n, s, parts, count, current) {
+    loaded[file] = 1
+    n = 0
+    current = ""
+    while ((getline line < file) > 0) {
+        n++
+        if (line ~ /^[A-Za-z_][A-Za-z0-9_ \t*]*[ \t*][A-Za-z_][A-Za-z0-9_]*[ \t]*\(/ &&
+            line !~ /;[ \t]*$/ &&
+            line !~ /^(typedef|return|else|if|for|while|switch|do)[ \t(]/) {
+            s = substr(line, 1, index(line, "(") - 1)
+            sub(/[ \t]+$/, "", s)
+            count = split(s, parts, /[ \t*]+/)
+            current = parts[count]
+        }
+        func_at[file, n] = current
+    }
+    close(file)
+}
+
+{
+    if (!match($0, /^[^: ]+:[0-9]+:[0-9]+: [a-z]+: /)) next
+
+    header = substr($0, 1, RLENGTH)
+    msg = substr($0, RLENGTH + 1)
+    split(header, field, ":")
+    file = field[1]
+    line = field[2] + 0
+    kind = field[4]
+    sub(/^ /, "", kind)
+
+    if (kind == "remark") {
+        if (msg ~ /\[-Rpass=/) type = "vectorized"
+        else if (msg ~ /\[-Rpass-missed=/) type = "missed"
+        else if (msg ~ /\[-Rpass-analysis=/) type = "reason"
+        else next
+        sub(/ *\[-Rpass[^]]*\]$/, "", msg)
+    } else if (kind == "optimized") {
+        type = "vectorized"
+    } else if (kind == "missed") {
+        type = (msg ~ /^couldn't vectorize loop/) ? "missed" : "reason"
+    } else {
+        next  # gcc "note:" chatter, warnings, errors
+    }
+
+    if (!(file in loaded)) load_functions(file)
+    fn = func_at[file, line]
+    if (fn == "") fn = "?"
+
+    key = fn SUBSEP file
+    if (!(key in seen_key)) {
+        seen_key[key] = 1
+        key_order[++key_total] = key
+    }
+
+    loc = file ":" line
+    if (type == "vectorized") {
+        if (!((loc, "v") in seen)) {
+            seen[loc, "v"] = 1
+            vec_count[key]++
+            total_vec++
+        }
+    } else if (type == "missed") {
+        if (!((loc, "m") in seen)) {
+            seen[loc, "m"] = 1
+            miss_count[key]++
+            miss_lines[key] = miss_lines[key] " " line
+            total_miss++
+        }
+    } else if (!((key, line, msg) in seen)) {
+        seen[key, line, msg] = 1
+        reasons[key] = reasons[key] sprintf("      %5d: %s\n", line, msg)
+    }
+}
+
+function print_missed(key,    parts, tag) {
+    split(key, parts, SUBSEP)
+    tag = (parts[1] in hot_pct) ? "  [" hot_pct[parts[1]] "]" : ""
+    printf "  %s (%s)%s\n", parts[1], parts[2], tag
+    printf "    loops at lines:%s\n", miss_lines[key]
+    if (reasons[key] != "") {
+        printf "    reasons:\n%s", reasons[key]
+    }
+    printf "\n"
+}
+
+END {
+    printf "Vectorization Report\n"
+    printf "====================\n\n"
+    printf "Loops: %d vectorized, %d missed\n\n", total_vec, total_miss
+
+    printf "  %-8s %-10s %s\n", "Missed", "Vectorized", "Function (file)"
+    sort_cmd = "sort -k1,1nr -k2,2nr -k3,3"
+    for (i = 1; i <= key_total; i++) {
+        key = key_order[i]
+        if (vec_count[key] + miss_count[key] == 0) continue
+        split(key, parts, SUBSEP)
+        printf "  %-8d %-10d %s (%s)\n", miss_count[key], vec_count[key], parts[1], parts[2] | sort_cmd
+    }
+    close(sort_cmd)
+
+    printf "\nMissed Vectorizations%s\n", (hot_count > 0) ? " (hot functions)" : ""
+    printf "---------------------\n\n"
+    listed = 0
+    if (hot_count > 0) {
+        for (h = 1; h <= hot_count; h++) {
+            for (i = 1; i <= key_total; i++) {
+                key = key_order[i]
+                split(key, parts, SUBSEP)
+                if (parts[1] == hot_names[h] && miss_count[key] > 0) {
+                    print_missed(key)
+                    listed++
+                }
+            }
+        }
+    } else {
+        for (i = 1; i <= key_total; i++) {
+            if (miss_count[key_order[i]] > 0) {
+                print_missed(key_order[i])
+                listed++
+            }
+        }
+    }
+    if (listed == 0) printf "  (none)\n"
+}